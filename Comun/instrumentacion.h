@@ -0,0 +1,241 @@
+// Instrumentacion compartida por los cuatro ejercicios (solo cabecera).
+//
+//   instr::Temporizador t("seccion");        // tiempo, asignaciones y hardware del bloque
+//   static uint64_t &n = instr::contador("x"); n++;   // contador con nombre
+//   instr::guardarReporte("reporte.json", "programa");
+//
+// Opciones al compilar (-D...), desactivadas por defecto; cada ejercicio es
+// un solo archivo .cpp, asi que el reemplazo de new/delete queda definido una vez:
+//   g++ -DINSTRUMENTACION_ASIGNACIONES -DINSTRUMENTACION_PERF MST.cpp
+//   INSTRUMENTACION_ASIGNACIONES  reemplaza operator new/delete para contar
+//                                 asignaciones y bytes pedidos
+//   INSTRUMENTACION_PERF          en Linux abre contadores de hardware con
+//                                 perf_event_open (ciclos, instrucciones,
+//                                 fallos de cache); si el sistema no lo
+//                                 permite, el reporte lo indica y sigue
+#ifndef INSTRUMENTACION_H
+#define INSTRUMENTACION_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include <string>
+
+#if defined(__linux__) && defined(INSTRUMENTACION_PERF)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace instr {
+
+// Asignaciones de memoria (solo cuentan con INSTRUMENTACION_ASIGNACIONES)
+struct Asignaciones {
+    uint64_t llamadas, bytes, liberaciones;
+};
+
+inline Asignaciones &asignaciones() {
+    static Asignaciones a = {0, 0, 0};
+    return a;
+}
+
+// Contadores de hardware: ciclos, instrucciones y fallos de cache
+const int NUM_HARDWARE = 3;
+
+struct Hardware {
+    int fd[NUM_HARDWARE] = {-1, -1, -1};
+    bool activo = false;
+    bool intentado = false;
+};
+
+inline Hardware &hardware() {
+    static Hardware h;
+    return h;
+}
+
+// abre los contadores la primera vez; devuelve si estan disponibles
+inline bool iniciarHardware() {
+    Hardware &h = hardware();
+    if (h.intentado) return h.activo;
+    h.intentado = true;
+#if defined(__linux__) && defined(INSTRUMENTACION_PERF)
+    const uint64_t eventos[NUM_HARDWARE] = {PERF_COUNT_HW_CPU_CYCLES,
+                                            PERF_COUNT_HW_INSTRUCTIONS,
+                                            PERF_COUNT_HW_CACHE_MISSES};
+    h.activo = true;
+    for (int i = 0; i < NUM_HARDWARE; i++) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = eventos[i];
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        h.fd[i] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (h.fd[i] < 0) h.activo = false;
+    }
+    if (!h.activo) {
+        for (int i = 0; i < NUM_HARDWARE; i++) {
+            if (h.fd[i] >= 0) close(h.fd[i]);
+            h.fd[i] = -1;
+        }
+    }
+#endif
+    return h.activo;
+}
+
+inline void leerHardware(uint64_t valores[NUM_HARDWARE]) {
+    for (int i = 0; i < NUM_HARDWARE; i++) valores[i] = 0;
+#if defined(__linux__) && defined(INSTRUMENTACION_PERF)
+    Hardware &h = hardware();
+    if (!h.activo) return;
+    for (int i = 0; i < NUM_HARDWARE; i++) {
+        if (read(h.fd[i], &valores[i], sizeof(uint64_t)) != sizeof(uint64_t)) valores[i] = 0;
+    }
+#endif
+}
+
+// Acumulado de cada seccion medida con Temporizador
+struct Seccion {
+    uint64_t llamadas = 0;
+    double tiempoMs = 0;
+    uint64_t asignaciones = 0, bytes = 0;
+    uint64_t hardware[NUM_HARDWARE] = {0, 0, 0};
+};
+
+struct Registro {
+    std::map<std::string, Seccion> secciones;
+    std::map<std::string, uint64_t> contadores;
+};
+
+inline Registro &registro() {
+    static Registro r;
+    return r;
+}
+
+// referencia estable al contador; guardarla en una variable static evita
+// buscar el nombre en cada incremento
+inline uint64_t &contador(const std::string &nombre) {
+    return registro().contadores[nombre];
+}
+
+inline double tiempoMs(const std::string &nombre) {
+    return registro().secciones[nombre].tiempoMs;
+}
+
+// Temporizador RAII: al salir del bloque suma a su seccion el tiempo
+// (steady_clock), las asignaciones y los contadores de hardware
+class Temporizador {
+public:
+    explicit Temporizador(const std::string &nombre) : nombre(nombre) {
+        iniciarHardware();
+        asignacionesInicio = asignaciones();
+        leerHardware(hardwareInicio);
+        inicio = std::chrono::steady_clock::now();
+    }
+    ~Temporizador() {
+        auto fin = std::chrono::steady_clock::now();
+        uint64_t hardwareFin[NUM_HARDWARE];
+        leerHardware(hardwareFin);
+        Asignaciones a = asignaciones();
+
+        Seccion &s = registro().secciones[nombre];
+        s.llamadas++;
+        s.tiempoMs += std::chrono::duration<double, std::milli>(fin - inicio).count();
+        s.asignaciones += a.llamadas - asignacionesInicio.llamadas;
+        s.bytes += a.bytes - asignacionesInicio.bytes;
+        for (int i = 0; i < NUM_HARDWARE; i++) s.hardware[i] += hardwareFin[i] - hardwareInicio[i];
+    }
+    Temporizador(const Temporizador &) = delete;
+    Temporizador &operator=(const Temporizador &) = delete;
+
+private:
+    std::string nombre;
+    std::chrono::steady_clock::time_point inicio;
+    Asignaciones asignacionesInicio;
+    uint64_t hardwareInicio[NUM_HARDWARE];
+};
+
+// Reporte en JSON con secciones, contadores y asignaciones totales
+inline void reporte(std::ostream &out, const std::string &programa) {
+    Registro &r = registro();
+    Asignaciones a = asignaciones();
+    out << "{\n  \"programa\": \"" << programa << "\",\n";
+    out << "  \"hardware\": " << (hardware().activo ? "true" : "false") << ",\n";
+    out << "  \"secciones\": [\n";
+    size_t k = 0;
+    for (const auto &par : r.secciones) {
+        const Seccion &s = par.second;
+        out << "    {\"nombre\": \"" << par.first << "\", \"llamadas\": " << s.llamadas
+            << ", \"tiempo_ms\": " << s.tiempoMs << ", \"asignaciones\": " << s.asignaciones
+            << ", \"bytes\": " << s.bytes;
+        if (hardware().activo) {
+            out << ", \"ciclos\": " << s.hardware[0] << ", \"instrucciones\": " << s.hardware[1]
+                << ", \"fallos_cache\": " << s.hardware[2];
+        }
+        out << "}" << (++k < r.secciones.size() ? "," : "") << "\n";
+    }
+    out << "  ],\n  \"contadores\": {";
+    k = 0;
+    for (const auto &par : r.contadores) {
+        out << (k++ ? ", " : "") << "\"" << par.first << "\": " << par.second;
+    }
+    out << "},\n";
+    out << "  \"asignaciones\": {\"llamadas\": " << a.llamadas << ", \"bytes\": " << a.bytes
+        << ", \"liberaciones\": " << a.liberaciones << "}\n}\n";
+}
+
+inline bool guardarReporte(const std::string &archivo, const std::string &programa) {
+    std::ofstream out(archivo.c_str());
+    if (!out) {
+        std::cerr << "No se pudo escribir el reporte " << archivo << std::endl;
+        return false;
+    }
+    reporte(out, programa);
+    return true;
+}
+
+} // namespace instr
+
+#ifdef INSTRUMENTACION_ASIGNACIONES
+// Reemplazo global de new/delete: no puede ser inline, por eso solo se
+// define en el archivo que activa la opcion
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void *operator new(std::size_t n) {
+    instr::Asignaciones &a = instr::asignaciones();
+    a.llamadas++;
+    a.bytes += n;
+    if (void *p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void *operator new[](std::size_t n) {
+    return operator new(n);
+}
+void operator delete(void *p) noexcept {
+    if (!p) return;
+    instr::asignaciones().liberaciones++;
+    std::free(p);
+}
+void operator delete[](void *p) noexcept {
+    operator delete(p);
+}
+void operator delete(void *p, std::size_t) noexcept {
+    operator delete(p);
+}
+void operator delete[](void *p, std::size_t) noexcept {
+    operator delete(p);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+#endif
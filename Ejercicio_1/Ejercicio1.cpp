@@ -9,6 +9,7 @@
 #include <numeric>
 #include <climits>
 #include <algorithm>
+#include "../Comun/instrumentacion.h"
 
 using namespace std;
 
@@ -79,8 +80,14 @@ int main() {
         resultado.monto = M;
         
         // Ejecutar ambos algoritmos
-        resultado.combinacion_greedy = cambio_greedy(M, canonico);
-        resultado.combinacion_bruteforce = cambio_bruteforce(M, canonico); // optimizada 
+        {
+            instr::Temporizador t("canonico/greedy");
+            resultado.combinacion_greedy = cambio_greedy(M, canonico);
+        }
+        {
+            instr::Temporizador t("canonico/bruteforce_memo");
+            resultado.combinacion_bruteforce = cambio_bruteforce(M, canonico); // optimizada 
+        }
         
         resultado.num_monedas_greedy = resultado.combinacion_greedy.size();
         resultado.num_monedas_bruteforce = resultado.combinacion_bruteforce.size();
@@ -115,8 +122,14 @@ int main() {
         resultado.monto = M;
         
         // Ejecutar ambos algoritmos
-        resultado.combinacion_greedy = cambio_greedy(M, no_canonico);
-        resultado.combinacion_bruteforce = cambio_bruteforce_puro(M, no_canonico); // fuerza bruta pura aquí
+        {
+            instr::Temporizador t("no_canonico/greedy");
+            resultado.combinacion_greedy = cambio_greedy(M, no_canonico);
+        }
+        {
+            instr::Temporizador t("no_canonico/bruteforce_puro");
+            resultado.combinacion_bruteforce = cambio_bruteforce_puro(M, no_canonico); // fuerza bruta pura aquí
+        }
         
         resultado.num_monedas_greedy = resultado.combinacion_greedy.size();
         resultado.num_monedas_bruteforce = resultado.combinacion_bruteforce.size();
@@ -180,12 +193,14 @@ int main() {
     cout << "Porcentaje: " << (coincidencias_no_canonico * 100.0 / 30) << "%\n";
     cout << "Primer M donde falla: " << (primer_M_diferente != -1 ? to_string(primer_M_diferente) : "No encontrado en rango 1-30") << "\n\n";
     
+    instr::guardarReporte("instrumentacion_ejercicio1.json", "Ejercicio1");
     return 0;
 }
 
 vector<int> cambio_greedy(int monto, vector<int> denominaciones) {
     sort(denominaciones.rbegin(), denominaciones.rend()); // ordenar de mayor a menor 
     
+    static uint64_t &monedas_greedy = instr::contador("monedas_greedy");
     vector<int> combinacion; 
     int i = 0;
     
@@ -193,6 +208,7 @@ vector<int> cambio_greedy(int monto, vector<int> denominaciones) {
         if(denominaciones[i] <= monto) {
             combinacion.push_back(denominaciones[i]);
             monto -= denominaciones[i];
+            monedas_greedy++;
         } else {
             i++; 
         }
@@ -203,6 +219,8 @@ vector<int> cambio_greedy(int monto, vector<int> denominaciones) {
 unordered_map<int, int> memo;
 
 int bruteforce_min_monedas(int monto, const vector<int>& denominaciones) {
+    static uint64_t &llamadas = instr::contador("memo_llamadas");
+    llamadas++;
     if (monto == 0) return 0;
     if (monto < 0) return INT_MAX;
     if (memo.find(monto) != memo.end()) return memo[monto];
@@ -241,6 +259,8 @@ vector<int> cambio_bruteforce(int monto, vector<int> denominaciones) {
 
 void fuerzaBrutaAux(int monto, const vector<int>& denominaciones, int index,
                     vector<int>& actual, vector<int>& mejor) {
+    static uint64_t &llamadas = instr::contador("fuerza_bruta_llamadas");
+    llamadas++;
     if (monto == 0) {
         if (mejor.empty() || actual.size() < mejor.size()) mejor = actual;
         return;
@@ -5,6 +5,7 @@
 #include <cstdlib>
 #include <fstream>
 #include <cctype>
+#include "../Comun/instrumentacion.h"
 using namespace std;
 
 // Estructura para guardar cada actividad
@@ -56,7 +57,9 @@ vector<Actividad> seleccion_fuerza_bruta(vector<Actividad> actividades) {
     int mayorNum = 0;
 
     // se prueban todos los subconjuntos posibles
+    static uint64_t &subconjuntos = instr::contador("fuerza_bruta_subconjuntos");
     for (int mask = 0; mask < (1 << n); mask++) {
+        subconjuntos++;
         vector<Actividad> opcion;
         for (int i = 0; i < n; i++) {
             if (mask & (1 << i)) {
@@ -132,13 +135,27 @@ int main() {
     cout << "Pruebas pequenas" << endl;
 
     int nSmall = 18;
-    vector<Actividad> actividadesSmall = generar(nSmall, 20, 10);
-    guardarJSON("actividades_small.json", actividadesSmall);
-
-    vector<Actividad> actividadesSmallLeidas = leerJSON("actividades_small.json");
-
-    vector<Actividad> eftSmall = seleccion_eft(actividadesSmallLeidas);
-    vector<Actividad> fbSmall = seleccion_fuerza_bruta(actividadesSmallLeidas);
+    vector<Actividad> actividadesSmall, actividadesSmallLeidas, eftSmall, fbSmall;
+    {
+        instr::Temporizador t("pequenas/generar");
+        actividadesSmall = generar(nSmall, 20, 10);
+    }
+    {
+        instr::Temporizador t("pequenas/guardar_json");
+        guardarJSON("actividades_small.json", actividadesSmall);
+    }
+    {
+        instr::Temporizador t("pequenas/leer_json");
+        actividadesSmallLeidas = leerJSON("actividades_small.json");
+    }
+    {
+        instr::Temporizador t("pequenas/eft");
+        eftSmall = seleccion_eft(actividadesSmallLeidas);
+    }
+    {
+        instr::Temporizador t("pequenas/fuerza_bruta");
+        fbSmall = seleccion_fuerza_bruta(actividadesSmallLeidas);
+    }
 
     cout << "EFT=" << eftSmall.size()
          << " | FuerzaBruta=" << fbSmall.size();
@@ -149,19 +166,29 @@ int main() {
     cout << "\nPruebas grandes" << endl;
 
     int nLarge = 10000;
-    vector<Actividad> actividadesGrandes = generar(nLarge, 10000, 100);
-    guardarJSON("actividades_large.json", actividadesGrandes);
-
-    vector<Actividad> actividadesLarge = leerJSON("actividades_large.json");
-
-    clock_t inicio = clock();
-    vector<Actividad> eftLarge = seleccion_eft(actividadesLarge);
-    clock_t fin = clock();
+    vector<Actividad> actividadesGrandes, actividadesLarge, eftLarge;
+    {
+        instr::Temporizador t("grandes/generar");
+        actividadesGrandes = generar(nLarge, 10000, 100);
+    }
+    {
+        instr::Temporizador t("grandes/guardar_json");
+        guardarJSON("actividades_large.json", actividadesGrandes);
+    }
+    {
+        instr::Temporizador t("grandes/leer_json");
+        actividadesLarge = leerJSON("actividades_large.json");
+    }
+    {
+        instr::Temporizador t("grandes/eft");
+        eftLarge = seleccion_eft(actividadesLarge);
+    }
 
-    double tiempo = double(fin - inicio) / CLOCKS_PER_SEC;
+    double tiempo = instr::tiempoMs("grandes/eft") / 1000.0;
 
     cout << "Seleccionadas=" << eftLarge.size()
          << " | Tiempo=" << tiempo << "s" << endl;
 
+    instr::guardarReporte("instrumentacion_seleccion.json", "Seleccion_Actividades");
     return 0;
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <cmath>
 #include <unordered_map>
 #include <iomanip>
+#include "../Comun/instrumentacion.h"
 
 using namespace std;
 
@@ -16,7 +17,10 @@ struct Node {
     Node* left;
     Node* right;
 
-    Node(int f, char c = 0) : frequency(f), character(c), left(nullptr), right(nullptr) {}
+    Node(int f, char c = 0) : frequency(f), character(c), left(nullptr), right(nullptr) {
+        static uint64_t &nodos = instr::contador("nodos_creados");
+        nodos++;
+    }
 };
 
 // Comparador para la cola de prioridad (menor frecuencia primero)
@@ -55,31 +59,44 @@ bool verifyPrefixProperty(const unordered_map<char, string>& codeMap) {
 }
 
 int main() {
-    string data = loadCorpus("corpus.txt");
+    string data;
+    {
+        instr::Temporizador t("cargar_corpus");
+        data = loadCorpus("corpus.txt");
+    }
 
     // Contar frecuencias de cada símbolo
     unordered_map<char, int> freqMap;
-    for (char c : data) freqMap[c]++;
+    {
+        instr::Temporizador t("frecuencias");
+        for (char c : data) freqMap[c]++;
+    }
 
     // Construir cola de prioridad con los nodos iniciales
     priority_queue<Node*, vector<Node*>, Compare> heap;
-    for (const auto& pair : freqMap) {
-        heap.push(new Node(pair.second, pair.first));
-    }
+    {
+        instr::Temporizador t("construir_arbol");
+        for (const auto& pair : freqMap) {
+            heap.push(new Node(pair.second, pair.first));
+        }
 
-    // Construcción del árbol de Huffman
-    while (heap.size() > 1) {
-        Node* lo = heap.top(); heap.pop();
-        Node* hi = heap.top(); heap.pop();
-        Node* merged = new Node(lo->frequency + hi->frequency);
-        merged->left = lo;
-        merged->right = hi;
-        heap.push(merged);
+        // Construcción del árbol de Huffman
+        while (heap.size() > 1) {
+            Node* lo = heap.top(); heap.pop();
+            Node* hi = heap.top(); heap.pop();
+            Node* merged = new Node(lo->frequency + hi->frequency);
+            merged->left = lo;
+            merged->right = hi;
+            heap.push(merged);
+        }
     }
 
     Node* root = heap.empty() ? nullptr : heap.top();
     unordered_map<char, string> codeMap;
-    generateCodes(root, "", codeMap);
+    {
+        instr::Temporizador t("generar_codigos");
+        generateCodes(root, "", codeMap);
+    }
 
     // Calcular longitud media y comparación con longitud fija
     double totalBits = 0;
@@ -109,9 +126,15 @@ int main() {
     cout << "--------------------------------------------------\n";
     cout << "\nLongitud media Huffman: " << avgLength << " bits/simbolos" << endl;
     cout << "Longitud fija: " << fixedLength << " bits/simbolo" << endl;
-    cout << "Propiedad de prefijo: " << (verifyPrefixProperty(codeMap) ? "Cumple" : "No cumple") << endl;
+    bool prefijo;
+    {
+        instr::Temporizador t("verificar_prefijo");
+        prefijo = verifyPrefixProperty(codeMap);
+    }
+    cout << "Propiedad de prefijo: " << (prefijo ? "Cumple" : "No cumple") << endl;
     cout << "longitud fija: " << (totalFreq * fixedLength) << " bits\n";
     cout << "Huffman: " << totalBits << " bits\n";
 
+    instr::guardarReporte("instrumentacion_huffman.json", "huffman");
     return 0;
 }
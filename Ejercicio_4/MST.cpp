@@ -3,11 +3,26 @@
 #include <queue>
 #include <fstream>
 #include <set>
+#include <array>
 #include <algorithm>
 #include <cstdlib>
 #include <ctime>
+#include <limits>
+#include <tuple>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <chrono>
+#include <sstream>
+#include <cerrno>
+#include "../Comun/instrumentacion.h"
 using namespace std;
 
+// Contadores de operaciones (instr::contador) que reporta el modo benchmark
+const char *CONTADORES_MST[] = {"finds", "pasos_find", "unites", "unites_exitosos",
+                                "heap_push", "heap_pop", "pops_obsoletos"};
+const int NUM_CONTADORES_MST = sizeof(CONTADORES_MST) / sizeof(CONTADORES_MST[0]);
+
 // Estructura para Kruskal
 struct UnionFind {
     vector<int> parent, size;
@@ -16,14 +31,23 @@ struct UnionFind {
         size.assign(numNodos, 1);
         for (int i = 0; i < numNodos; i++) parent[i] = i;
     }
+    // pasosFind cuenta cada nivel recorrido (longitud del camino a la raiz)
     int find(int x) {
+        static uint64_t &pasosFind = instr::contador("pasos_find");
         if (parent[x] == x) return x;
+        pasosFind++;
         return parent[x] = find(parent[x]); 
     }
     bool unite(int a, int b) {
+        static uint64_t &unites = instr::contador("unites");
+        static uint64_t &finds = instr::contador("finds");
+        static uint64_t &unitesExitosos = instr::contador("unites_exitosos");
+        unites++;
+        finds += 2;
         a = find(a);
         b = find(b);
         if (a == b) return false;
+        unitesExitosos++;
         if (size[a] < size[b]) swap(a, b);
         parent[b] = a;
         size[a] += size[b];
@@ -36,68 +60,534 @@ struct Edge {
     int u, v, w;
 };
 
-// kruskal
-int kruskal(int numNodos, vector<Edge> &edges) {
+// resultado de un MST: aristas del arbol y costo total en 64 bits
+struct ResultadoMST {
+    vector<Edge> aristas;
+    int64_t costo = 0;
+};
+
+// ordenar aristas por peso (primera fase de kruskal)
+void ordenarAristas(vector<Edge> &edges) {
     sort(edges.begin(), edges.end(), [](Edge A, Edge B) {
         return A.w < B.w;
     });
+}
 
+// kruskal sobre aristas ya ordenadas
+ResultadoMST kruskalOrdenado(int numNodos, const vector<Edge> &edges) {
     UnionFind uf(numNodos);
-    int total = 0;
-    int taken = 0;
+    ResultadoMST res;
 
     for (auto &e : edges) {
         if (uf.unite(e.u, e.v)) {
-            total += e.w;
-            taken++;
-            if (taken == numNodos - 1) break;
+            res.costo += e.w;
+            res.aristas.push_back(e);
+            if ((int)res.aristas.size() == numNodos - 1) break;
         }
     }
-    return total;
+    return res;
+}
+
+// kruskal
+ResultadoMST kruskal(int numNodos, vector<Edge> &edges) {
+    ordenarAristas(edges);
+    return kruskalOrdenado(numNodos, edges);
 }
 
 // Prim 
-int prim(int numNodos, vector<vector<pair<int,int>>> &visitado) {
+ResultadoMST prim(int numNodos, vector<vector<pair<int,int>>> &visitado) {
     vector<bool> marcado(numNodos, false);
-    priority_queue<pair<int,int>, vector<pair<int,int>>, greater<pair<int,int>>> cola;
-    cola.push(make_pair(0, 0));
+    // (peso, nodo, desde): desde es -1 para la raiz
+    priority_queue<tuple<int,int,int>, vector<tuple<int,int,int>>, greater<tuple<int,int,int>>> cola;
+    static uint64_t &pushes = instr::contador("heap_push");
+    static uint64_t &pops = instr::contador("heap_pop");
+    static uint64_t &popsObsoletos = instr::contador("pops_obsoletos");
+    cola.push(make_tuple(0, 0, -1));
+    pushes++;
 
-    int total = 0, usados = 0;
+    ResultadoMST res;
+    int usados = 0;
 
     while (!cola.empty() && usados < numNodos) {
-        pair<int,int> minimo = cola.top();
+        int peso, nodo, desde;
+        tie(peso, nodo, desde) = cola.top();
         cola.pop();
-        int peso = minimo.first;
-        int nodo = minimo.second;
+        pops++;
 
-        if (marcado[nodo]) continue;
+        if (marcado[nodo]) {
+            popsObsoletos++;
+            continue;
+        }
         marcado[nodo] = true;
-        total += peso;
+        res.costo += peso;
+        if (desde != -1) res.aristas.push_back({desde, nodo, peso});
         usados++;
 
         for (auto &p : visitado[nodo]) {
             if (!marcado[p.first]) {
-                cola.push(make_pair(p.second, p.first));
+                cola.push(make_tuple(p.second, p.first, nodo));
+                pushes++;
             }
         }
     }
-    return total;
+    return res;
+}
+
+// Formatos de archivo de aristas: texto "u v w" por linea (como grafo_.txt)
+// o binario con tres int32_t por arista. Se usa binario si termina en .bin
+bool esBinario(const string &file) {
+    return file.size() >= 4 && file.compare(file.size() - 4, 4, ".bin") == 0;
+}
+
+// en texto se saltan los espacios antes de cada arista, asi un fallo de
+// lectura sin llegar a EOF o con EOF a media arista deja failbit activo
+bool leerArista(istream &in, Edge &e, bool binario) {
+    if (!binario) {
+        // si la ultima arista termino justo en EOF, ws marcaria failbit
+        if (in.eof()) return false;
+        in >> ws;
+        if (in.eof()) return false;
+        return (bool)(in >> e.u >> e.v >> e.w);
+    }
+    int32_t datos[3];
+    if (!in.read(reinterpret_cast<char*>(datos), sizeof(datos))) return false;
+    e.u = datos[0];
+    e.v = datos[1];
+    e.w = datos[2];
+    return true;
+}
+
+// tras el ultimo leerArista: true si se llego al final sin una arista incompleta
+bool lecturaCompleta(istream &in, bool binario) {
+    if (binario) return in.eof() && !in.bad() && in.gcount() == 0;
+    return in.eof() && !in.fail();
+}
+
+void escribirArista(ostream &out, const Edge &e, bool binario) {
+    if (!binario) {
+        out << e.u << " " << e.v << " " << e.w << "\n";
+        return;
+    }
+    int32_t datos[3] = {e.u, e.v, e.w};
+    out.write(reinterpret_cast<const char*>(datos), sizeof(datos));
+}
+
+bool escribirAristas(string file, const vector<Edge> &aristas) {
+    bool binario = esBinario(file);
+    ofstream out(file.c_str(), binario ? ios::binary : ios::out);
+    if (!out) {
+        cerr << "No se pudo escribir el archivo " << file << endl;
+        return false;
+    }
+    for (auto &e : aristas) escribirArista(out, e, binario);
+    out.close();
+    if (out.fail()) {
+        cerr << "No se pudo escribir el archivo " << file << endl;
+        return false;
+    }
+    return true;
 }
 
+// Kruskal externo para archivos de aristas que no caben en memoria.
+// Fase 1: se leen bloques de aristasPorBloque aristas, se ordenan y se
+// guardan como corridas binarias junto al archivo. Fase 2: las corridas se
+// mezclan de a lo mas FAN_IN_EXTERNO a la vez (varias pasadas si hay mas) y
+// la ultima mezcla pasa cada arista por UnionFind. En RAM solo quedan
+// UnionFind (O(V)), el arbol resultante y un bloque de aristas.
+const int FAN_IN_EXTERNO = 16;
+
+bool escribirCorrida(const string &nombre, const vector<Edge> &bloque) {
+    ofstream out(nombre.c_str(), ios::binary);
+    if (!out) return false;
+    for (auto &a : bloque) escribirArista(out, a, true);
+    out.close();
+    return !out.fail();
+}
+
+// mezcla las corridas en orden de peso y entrega cada arista a consumir,
+// que devuelve false para terminar antes
+template <class Consumir>
+bool mezclarCorridas(const vector<string> &corridas, Consumir consumir) {
+    vector<ifstream> lectores(corridas.size());
+    vector<Edge> actual(corridas.size());
+    // (peso, corrida) de la siguiente arista de cada corrida
+    priority_queue<pair<int,int>, vector<pair<int,int>>, greater<pair<int,int>>> cola;
+    for (int i = 0; i < (int)corridas.size(); i++) {
+        lectores[i].open(corridas[i].c_str(), ios::binary);
+        if (!lectores[i]) return false;
+        if (leerArista(lectores[i], actual[i], true)) cola.push({actual[i].w, i});
+        else if (!lecturaCompleta(lectores[i], true)) return false;
+    }
+
+    while (!cola.empty()) {
+        int i = cola.top().second;
+        cola.pop();
+        if (!consumir(actual[i])) return true;
+        if (leerArista(lectores[i], actual[i], true)) cola.push({actual[i].w, i});
+        else if (!lecturaCompleta(lectores[i], true)) return false;
+    }
+    return true;
+}
+
+bool kruskalExterno(string file, ResultadoMST &res, size_t aristasPorBloque = 1 << 20) {
+    res = ResultadoMST();
+    if (aristasPorBloque == 0) {
+        cerr << "El bloque debe tener al menos una arista" << endl;
+        return false;
+    }
+    bool binario = esBinario(file);
+    ifstream in(file.c_str(), binario ? ios::binary : ios::in);
+    if (!in) {
+        cerr << "No se pudo abrir el archivo " << file << endl;
+        return false;
+    }
+
+    // todos los archivos temporales creados, para borrarlos al final
+    vector<string> temporales;
+    auto nuevaCorrida = [&]() {
+        temporales.push_back(file + ".corrida" + to_string(temporales.size()) + ".bin");
+        return temporales.back();
+    };
+    auto fallar = [&](const string &mensaje) {
+        cerr << mensaje << endl;
+        for (auto &nombre : temporales) remove(nombre.c_str());
+        return false;
+    };
+
+    vector<string> corridas;
+    vector<Edge> bloque;
+    bloque.reserve(aristasPorBloque);
+    int maxNode = -1;
+    Edge e;
+    bool quedan = true;
+    while (quedan) {
+        bloque.clear();
+        while (bloque.size() < aristasPorBloque && (quedan = leerArista(in, e, binario))) {
+            bloque.push_back(e);
+            maxNode = max(maxNode, max(e.u, e.v));
+        }
+        if (!quedan && !lecturaCompleta(in, binario)) {
+            return fallar("Formato invalido en " + file);
+        }
+        if (bloque.empty()) break;
+        sort(bloque.begin(), bloque.end(), [](Edge A, Edge B) {
+            return A.w < B.w;
+        });
+        string nombre = nuevaCorrida();
+        if (!escribirCorrida(nombre, bloque)) {
+            return fallar("No se pudo escribir la corrida " + nombre);
+        }
+        corridas.push_back(nombre);
+    }
+    vector<Edge>().swap(bloque);
+
+    // pasadas intermedias hasta que queden FAN_IN_EXTERNO corridas o menos
+    while ((int)corridas.size() > FAN_IN_EXTERNO) {
+        vector<string> siguientes;
+        for (size_t i = 0; i < corridas.size(); i += FAN_IN_EXTERNO) {
+            size_t fin = min(corridas.size(), i + FAN_IN_EXTERNO);
+            vector<string> grupo(corridas.begin() + i, corridas.begin() + fin);
+            string nombre = nuevaCorrida();
+            ofstream out(nombre.c_str(), ios::binary);
+            if (!out) return fallar("No se pudo escribir la corrida " + nombre);
+            bool ok = mezclarCorridas(grupo, [&](const Edge &a) {
+                escribirArista(out, a, true);
+                return (bool)out;
+            });
+            out.close();
+            if (!ok || out.fail()) return fallar("Fallo la mezcla de corridas en " + nombre);
+            for (auto &g : grupo) remove(g.c_str());
+            siguientes.push_back(nombre);
+        }
+        corridas.swap(siguientes);
+    }
+
+    int V = maxNode + 1;
+    UnionFind uf(V);
+    bool ok = mezclarCorridas(corridas, [&](const Edge &a) {
+        if (uf.unite(a.u, a.v)) {
+            res.costo += a.w;
+            res.aristas.push_back(a);
+        }
+        return (int)res.aristas.size() < V - 1;
+    });
+    if (!ok) return fallar("No se pudieron leer las corridas de " + file);
+
+    for (auto &nombre : temporales) remove(nombre.c_str());
+    return true;
+}
+
+// Link-cut tree: bosque de arboles dinamicos con consulta del maximo en un camino.
+// Los nodos 0..V-1 son vertices y cada arista del arbol es tambien un nodo con
+// su peso, asi el maximo del camino u-v es la arista mas pesada del ciclo.
+struct LinkCut {
+    vector<int> padre, valor, maxId;
+    vector<array<int,2>> hijo;
+    vector<bool> invertido;
+    vector<int> pila;
+
+    int agregarNodo(int w) {
+        padre.push_back(-1);
+        hijo.push_back({-1, -1});
+        valor.push_back(w);
+        maxId.push_back((int)valor.size() - 1);
+        invertido.push_back(false);
+        return (int)valor.size() - 1;
+    }
+    bool esRaiz(int x) {
+        int p = padre[x];
+        return p == -1 || (hijo[p][0] != x && hijo[p][1] != x);
+    }
+    void actualizar(int x) {
+        maxId[x] = x;
+        for (int c : hijo[x]) {
+            if (c != -1 && valor[maxId[c]] > valor[maxId[x]]) maxId[x] = maxId[c];
+        }
+    }
+    void bajar(int x) {
+        if (!invertido[x]) return;
+        swap(hijo[x][0], hijo[x][1]);
+        for (int c : hijo[x]) {
+            if (c != -1) invertido[c] = !invertido[c];
+        }
+        invertido[x] = false;
+    }
+    void rotar(int x) {
+        int y = padre[x], z = padre[y];
+        int d = (hijo[y][1] == x);
+        if (!esRaiz(y)) {
+            if (hijo[z][0] == y) hijo[z][0] = x;
+            else hijo[z][1] = x;
+        }
+        padre[x] = z;
+        hijo[y][d] = hijo[x][!d];
+        if (hijo[x][!d] != -1) padre[hijo[x][!d]] = y;
+        hijo[x][!d] = y;
+        padre[y] = x;
+        actualizar(y);
+        actualizar(x);
+    }
+    void splay(int x) {
+        pila.clear();
+        int y = x;
+        pila.push_back(y);
+        while (!esRaiz(y)) {
+            y = padre[y];
+            pila.push_back(y);
+        }
+        for (int i = (int)pila.size() - 1; i >= 0; i--) bajar(pila[i]);
+        while (!esRaiz(x)) {
+            int y = padre[x], z = padre[y];
+            if (!esRaiz(y)) {
+                rotar((hijo[y][0] == x) == (hijo[z][0] == y) ? y : x);
+            }
+            rotar(x);
+        }
+    }
+    void access(int x) {
+        int ultimo = -1;
+        for (int y = x; y != -1; y = padre[y]) {
+            splay(y);
+            hijo[y][1] = ultimo;
+            actualizar(y);
+            ultimo = y;
+        }
+        splay(x);
+    }
+    void hacerRaiz(int x) {
+        access(x);
+        invertido[x] = !invertido[x];
+    }
+    int buscarRaiz(int x) {
+        access(x);
+        while (true) {
+            bajar(x);
+            if (hijo[x][0] == -1) break;
+            x = hijo[x][0];
+        }
+        splay(x);
+        return x;
+    }
+    bool conectados(int a, int b) {
+        return buscarRaiz(a) == buscarRaiz(b);
+    }
+    void link(int a, int b) {
+        hacerRaiz(a);
+        padre[a] = b;
+    }
+    void cut(int a, int b) {
+        hacerRaiz(a);
+        access(b);
+        // a queda como hijo izquierdo de b, sin nada mas en el camino
+        hijo[b][0] = -1;
+        padre[a] = -1;
+        actualizar(b);
+    }
+    // nodo de mayor valor en el camino a-b (deben estar conectados)
+    int maximoCamino(int a, int b) {
+        hacerRaiz(a);
+        access(b);
+        return maxId[b];
+    }
+    void cambiarValor(int x, int w) {
+        access(x);
+        valor[x] = w;
+        actualizar(x);
+    }
+};
+
+// MST dinamico: se parte de las aristas del MST y se mantiene bajo cambios.
+// Insertar y disminuir peso cuestan O(log V) amortizado: si la arista cierra un
+// ciclo, se cambia por la mas pesada del ciclo. Eliminar o aumentar el peso de
+// una arista del arbol requiere buscar reemplazo entre las aristas fuera del
+// arbol, O(E log V); sobre aristas fuera del arbol es O(1).
+struct MSTDinamico {
+    int numNodos;
+    vector<Edge> aristas;
+    vector<bool> enArbol, activa;
+    LinkCut lct;
+    int64_t total = 0;
+
+    MSTDinamico(int numNodos, const vector<Edge> &arbol) : numNodos(numNodos) {
+        for (int i = 0; i < numNodos; i++) {
+            lct.agregarNodo(numeric_limits<int>::min());
+        }
+        for (auto &e : arbol) insertarArista(e.u, e.v, e.w);
+    }
+
+    // devuelve el id de la arista, que se usa en las demas operaciones,
+    // o -1 si algun extremo no es un vertice
+    int insertarArista(int u, int v, int w) {
+        if (u < 0 || u >= numNodos || v < 0 || v >= numNodos) return -1;
+        int id = aristas.size();
+        aristas.push_back({u, v, w});
+        enArbol.push_back(false);
+        activa.push_back(true);
+        lct.agregarNodo(w);
+        ofrecer(id);
+        return id;
+    }
+
+    // las operaciones sobre ids devuelven false si el id no existe, ya fue
+    // eliminado o el nuevo peso va en la direccion contraria
+    bool disminuirPeso(int id, int w) {
+        if (!valida(id) || w > aristas[id].w) return false;
+        Edge &e = aristas[id];
+        if (enArbol[id]) total -= e.w - w;
+        e.w = w;
+        lct.cambiarValor(numNodos + id, w);
+        if (!enArbol[id]) ofrecer(id);
+        return true;
+    }
+
+    bool aumentarPeso(int id, int w) {
+        if (!valida(id) || w < aristas[id].w) return false;
+        Edge &e = aristas[id];
+        if (!enArbol[id]) {
+            e.w = w;
+            lct.cambiarValor(numNodos + id, w);
+            return true;
+        }
+        cortar(id);
+        e.w = w;
+        lct.cambiarValor(numNodos + id, w);
+        reconectar(e.u, e.v);
+        return true;
+    }
+
+    // elige disminuir o aumentar segun el nuevo peso
+    bool cambiarPeso(int id, int w) {
+        if (!valida(id)) return false;
+        if (w == aristas[id].w) return true;
+        return w < aristas[id].w ? disminuirPeso(id, w) : aumentarPeso(id, w);
+    }
+
+    bool eliminarArista(int id) {
+        if (!valida(id)) return false;
+        activa[id] = false;
+        if (enArbol[id]) {
+            cortar(id);
+            reconectar(aristas[id].u, aristas[id].v);
+        }
+        return true;
+    }
+
+    int64_t costo() const { return total; }
+
+    vector<Edge> aristasArbol() const {
+        vector<Edge> arbol;
+        for (int i = 0; i < (int)aristas.size(); i++) {
+            if (enArbol[i]) arbol.push_back(aristas[i]);
+        }
+        return arbol;
+    }
+
+    // auxiliares
+    bool valida(int id) const {
+        return id >= 0 && id < (int)aristas.size() && activa[id];
+    }
+    void enlazar(int id) {
+        lct.link(aristas[id].u, numNodos + id);
+        lct.link(numNodos + id, aristas[id].v);
+        enArbol[id] = true;
+        total += aristas[id].w;
+    }
+    void cortar(int id) {
+        lct.cut(aristas[id].u, numNodos + id);
+        lct.cut(numNodos + id, aristas[id].v);
+        enArbol[id] = false;
+        total -= aristas[id].w;
+    }
+    // intentar meter una arista fuera del arbol
+    void ofrecer(int id) {
+        Edge &e = aristas[id];
+        if (e.u == e.v) return;
+        if (!lct.conectados(e.u, e.v)) {
+            enlazar(id);
+            return;
+        }
+        int m = lct.maximoCamino(e.u, e.v);
+        if (lct.valor[m] > e.w) {
+            cortar(m - numNodos);
+            enlazar(id);
+        }
+    }
+    // tras cortar una arista, unir las componentes de a y b con la mas liviana.
+    // Las raices no cambian durante el recorrido, asi que se calculan una vez
+    void reconectar(int a, int b) {
+        int raizA = lct.buscarRaiz(a), raizB = lct.buscarRaiz(b);
+        int mejor = -1;
+        for (int i = 0; i < (int)aristas.size(); i++) {
+            if (!activa[i] || enArbol[i]) continue;
+            if (mejor != -1 && aristas[i].w >= aristas[mejor].w) continue;
+            int rx = lct.buscarRaiz(aristas[i].u), ry = lct.buscarRaiz(aristas[i].v);
+            if ((rx == raizA && ry == raizB) || (rx == raizB && ry == raizA)) {
+                mejor = i;
+            }
+        }
+        if (mejor != -1) enlazar(mejor);
+    }
+};
+
 // leer grafo desde el archivo
 bool leerGrafo(string file, int &V, vector<Edge> &edges,
                vector<vector<pair<int,int>>> &visitado) {
-    ifstream in(file.c_str());
+    bool binario = esBinario(file);
+    ifstream in(file.c_str(), binario ? ios::binary : ios::in);
     if (!in) {
-        cout << "No se pudo abrir el archivo" << file << endl;
+        cerr << "No se pudo abrir el archivo " << file << endl;
         return false;
     }
-    int a, b, w;
+    Edge e;
     int maxNode = -1;
     edges.clear();
-    while (in >> a >> b >> w) {
-        edges.push_back({a, b, w});
-        maxNode = max(maxNode, max(a, b));
+    while (leerArista(in, e, binario)) {
+        edges.push_back(e);
+        maxNode = max(maxNode, max(e.u, e.v));
+    }
+    if (!lecturaCompleta(in, binario)) {
+        cerr << "Formato invalido en " << file << endl;
+        return false;
     }
     V = maxNode + 1;
     visitado.assign(V, {});
@@ -110,15 +600,16 @@ bool leerGrafo(string file, int &V, vector<Edge> &edges,
 
 // funcion para generar grafo 
 void generarGrafo(int V, int E, vector<Edge> &edges,
-                  vector<vector<pair<int,int>>> &visitado) {
+                  vector<vector<pair<int,int>>> &visitado,
+                  unsigned semilla = time(0)) {
     edges.clear();
     visitado.assign(V, {});
 
-    int maxE = V * (V - 1) / 2;
-    if (E > maxE) E = maxE;
+    int64_t maxE = (int64_t)V * (V - 1) / 2;
+    if (E > maxE) E = (int)maxE;
 
     set<pair<int,int>> usados;
-    srand(time(0));
+    srand(semilla);
 
     while ((int)edges.size() < E) {
         int u = rand() % V;
@@ -134,15 +625,388 @@ void generarGrafo(int V, int E, vector<Edge> &edges,
     }
 }
 
-int main() {
+// comparar el MST dinamico contra recalcular kruskal desde cero en cada cambio
+bool validarMSTDinamico(int V, int E, int operaciones) {
+    if (V < 1) {
+        cerr << "Numero de nodos invalido: " << V << endl;
+        return false;
+    }
+    vector<Edge> edges;
+    vector<vector<pair<int,int>>> visitado;
+    generarGrafo(V, E, edges, visitado);
+
+    vector<Edge> copia = edges;
+    vector<Edge> arbol = kruskal(V, copia).aristas;
+    MSTDinamico dinamico(V, arbol);
+
+    // el mismo grafo indexado por el id que devuelve MSTDinamico
+    vector<Edge> espejo = arbol;
+    vector<bool> viva(espejo.size(), true);
+    set<pair<int,int>> enMST;
+    for (auto &e : arbol) enMST.insert({min(e.u, e.v), max(e.u, e.v)});
+    for (auto &e : edges) {
+        if (enMST.count({min(e.u, e.v), max(e.u, e.v)})) continue;
+        dinamico.insertarArista(e.u, e.v, e.w);
+        espejo.push_back(e);
+        viva.push_back(true);
+    }
+
+    // extremos fuera de [0, V) se rechazan sin tocar el arbol
+    int64_t costoInicial = dinamico.costo();
+    if (dinamico.insertarArista(0, V, 1) != -1 || dinamico.insertarArista(-1, 0, 1) != -1 ||
+        dinamico.costo() != costoInicial) {
+        cout << "Se acepto una arista con un vertice invalido\n";
+        return false;
+    }
+
+    for (int op = 0; op < operaciones; op++) {
+        int tipo = rand() % 5;
+        // sin aristas todavia solo se puede insertar
+        int id = espejo.empty() ? -1 : rand() % espejo.size();
+        bool ok = true;
+        if (id == -1) {
+            tipo = 0;
+        } else if (!viva[id]) {
+            // una arista eliminada no se puede modificar ni eliminar de nuevo
+            ok = !dinamico.disminuirPeso(id, 1) && !dinamico.aumentarPeso(id, 100) &&
+                 !dinamico.cambiarPeso(id, 5) && !dinamico.eliminarArista(id);
+            tipo = 0;
+        }
+        if (tipo == 0) {
+            int u = rand() % V, v = rand() % V;
+            int w = 1 + rand() % 20;
+            dinamico.insertarArista(u, v, w);
+            espejo.push_back({u, v, w});
+            viva.push_back(true);
+        } else if (tipo == 1) {
+            int w = max(1, espejo[id].w - 1 - rand() % 5);
+            // en la direccion contraria se rechaza sin cambiar nada
+            ok = (w == espejo[id].w || !dinamico.aumentarPeso(id, w)) &&
+                 dinamico.disminuirPeso(id, w);
+            espejo[id].w = w;
+        } else if (tipo == 2) {
+            int w = espejo[id].w + 1 + rand() % 5;
+            ok = !dinamico.disminuirPeso(id, w) && dinamico.aumentarPeso(id, w);
+            espejo[id].w = w;
+        } else if (tipo == 3) {
+            int w = 1 + rand() % 20;
+            ok = dinamico.cambiarPeso(id, w);
+            espejo[id].w = w;
+        } else {
+            ok = dinamico.eliminarArista(id);
+            viva[id] = false;
+        }
+        if (!ok) {
+            cout << "Resultado inesperado de la operacion " << op << "\n";
+            return false;
+        }
+
+        vector<Edge> actuales;
+        for (int i = 0; i < (int)espejo.size(); i++) {
+            if (viva[i]) actuales.push_back(espejo[i]);
+        }
+        int64_t esperado = kruskal(V, actuales).costo;
+        if (dinamico.costo() != esperado) {
+            cout << "Diferencia en la operacion " << op << ": dinamico="
+                 << dinamico.costo() << " recalculado=" << esperado << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Modo benchmark (no interactivo). Ejemplo:
+//   ./MST --bench --nodos 1000,5000 --densidad disperso,denso,0.1
+//         --repeticiones 5 --calentamiento 1 --formato csv --salida res.csv
+// Con --archivo se carga el grafo en vez de generarlo. La densidad puede ser
+// disperso (3V), denso (V(V-1)/4) o una fraccion de V(V-1)/2.
+struct MedicionMST {
+    int V;
+    string densidad;
+    size_t E;
+    int repeticion;
+    double tCarga, tGeneracion, tOrden, tKruskal, tPrim;
+    int64_t costoKruskal, costoPrim;
+    uint64_t cont[NUM_CONTADORES_MST];
+};
+
+// ejecuta f dentro de un instr::Temporizador y devuelve los ms de esta llamada
+template <class F>
+double medirFase(const string &fase, F f) {
+    double previo = instr::tiempoMs(fase);
+    {
+        instr::Temporizador t(fase);
+        f();
+    }
+    return instr::tiempoMs(fase) - previo;
+}
+
+vector<string> separar(const string &texto, char sep) {
+    vector<string> partes;
+    stringstream ss(texto);
+    string parte;
+    while (getline(ss, parte, sep)) {
+        if (!parte.empty()) partes.push_back(parte);
+    }
+    return partes;
+}
+
+// entero completo (sin texto sobrante) que cabe en int
+bool leerEntero(const string &texto, int &valor) {
+    char *fin;
+    errno = 0;
+    long n = strtol(texto.c_str(), &fin, 10);
+    if (fin == texto.c_str() || *fin != '\0' || errno == ERANGE) return false;
+    if (n < numeric_limits<int>::min() || n > numeric_limits<int>::max()) return false;
+    valor = (int)n;
+    return true;
+}
+
+// numero de aristas en 64 bits para que V(V-1) no desborde; -1 si la
+// densidad no es valida
+int64_t aristasPorDensidad(int V, const string &densidad) {
+    int64_t pares = (int64_t)V * (V - 1) / 2;
+    if (densidad == "disperso") return 3 * (int64_t)V;
+    if (densidad == "denso") return pares / 2;
+    char *fin;
+    double fraccion = strtod(densidad.c_str(), &fin);
+    if (fin == densidad.c_str() || *fin != '\0' || !(fraccion >= 0 && fraccion <= 1)) return -1;
+    return (int64_t)(fraccion * pares);
+}
+
+bool medirMST(int V, const string &densidad, const string &archivo,
+              unsigned semilla, MedicionMST &m) {
+    m = MedicionMST();
+    m.densidad = densidad;
+    vector<Edge> edges;
+    vector<vector<pair<int,int>>> visitado;
+
+    uint64_t antes[NUM_CONTADORES_MST];
+    for (int i = 0; i < NUM_CONTADORES_MST; i++) antes[i] = instr::contador(CONTADORES_MST[i]);
+
+    bool cargado = true;
+    if (!archivo.empty()) {
+        m.tCarga = medirFase("bench/carga", [&]() {
+            cargado = leerGrafo(archivo, V, edges, visitado);
+        });
+        if (!cargado) return false;
+    } else {
+        m.tGeneracion = medirFase("bench/generacion", [&]() {
+            generarGrafo(V, (int)aristasPorDensidad(V, densidad), edges, visitado, semilla);
+        });
+    }
+    m.V = V;
+    m.E = edges.size();
+
+    // kruskal ordena una copia para no alterar el grafo compartido
+    vector<Edge> copia = edges;
+    m.tOrden = medirFase("bench/orden", [&]() { ordenarAristas(copia); });
+    m.tKruskal = medirFase("bench/kruskal", [&]() {
+        m.costoKruskal = kruskalOrdenado(V, copia).costo;
+    });
+    m.tPrim = medirFase("bench/prim", [&]() {
+        m.costoPrim = prim(V, visitado).costo;
+    });
+
+    for (int i = 0; i < NUM_CONTADORES_MST; i++) {
+        m.cont[i] = instr::contador(CONTADORES_MST[i]) - antes[i];
+    }
+    return true;
+}
+
+void escribirMediciones(ostream &out, const vector<MedicionMST> &mediciones, bool json) {
+    vector<string> campos = {"V", "densidad", "E", "repeticion", "t_carga_ms",
+                             "t_generacion_ms", "t_orden_ms", "t_kruskal_ms", "t_prim_ms",
+                             "costo_kruskal", "costo_prim"};
+    for (int i = 0; i < NUM_CONTADORES_MST; i++) campos.push_back(CONTADORES_MST[i]);
+    if (!json) {
+        for (size_t i = 0; i < campos.size(); i++) out << (i ? "," : "") << campos[i];
+        out << "\n";
+    } else {
+        out << "[\n";
+    }
+    for (size_t k = 0; k < mediciones.size(); k++) {
+        const MedicionMST &m = mediciones[k];
+        vector<stringstream> valores(campos.size());
+        valores[0] << m.V;
+        valores[1] << (json ? "\"" + m.densidad + "\"" : m.densidad);
+        valores[2] << m.E;
+        valores[3] << m.repeticion;
+        valores[4] << m.tCarga;
+        valores[5] << m.tGeneracion;
+        valores[6] << m.tOrden;
+        valores[7] << m.tKruskal;
+        valores[8] << m.tPrim;
+        valores[9] << m.costoKruskal;
+        valores[10] << m.costoPrim;
+        for (int i = 0; i < NUM_CONTADORES_MST; i++) valores[11 + i] << m.cont[i];
+        if (json) out << "  {";
+        for (size_t i = 0; i < campos.size(); i++) {
+            if (json) out << (i ? ", " : "") << "\"" << campos[i] << "\": " << valores[i].str();
+            else out << (i ? "," : "") << valores[i].str();
+        }
+        if (json) out << "}" << (k + 1 < mediciones.size() ? "," : "");
+        out << "\n";
+    }
+    if (json) out << "]\n";
+}
+
+int benchmark(int argc, char *argv[]) {
+    vector<string> nodos = {"1000"}, densidades = {"disperso"};
+    string archivo, salida, formato = "csv";
+    int repeticiones = 3, calentamiento = 1;
+    unsigned semilla = time(0);
+
+    for (int i = 2; i < argc; i += 2) {
+        string op = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "Falta el valor de la opcion " << op << "\n";
+            return 1;
+        }
+        string valor = argv[i + 1];
+        bool valido = true;
+        if (op == "--nodos") nodos = separar(valor, ',');
+        else if (op == "--densidad") densidades = separar(valor, ',');
+        else if (op == "--repeticiones") valido = leerEntero(valor, repeticiones) && repeticiones >= 1;
+        else if (op == "--calentamiento") valido = leerEntero(valor, calentamiento) && calentamiento >= 0;
+        else if (op == "--formato") formato = valor;
+        else if (op == "--archivo") archivo = valor;
+        else if (op == "--salida") salida = valor;
+        else if (op == "--semilla") {
+            int n;
+            valido = leerEntero(valor, n) && n >= 0;
+            semilla = n;
+        } else {
+            cerr << "Opcion desconocida: " << op << "\n";
+            return 1;
+        }
+        if (!valido) {
+            cerr << "Valor invalido para " << op << ": " << valor << "\n";
+            return 1;
+        }
+    }
+    if (formato != "csv" && formato != "json") {
+        cerr << "Formato desconocido: " << formato << " (csv o json)\n";
+        return 1;
+    }
+    // con archivo el tamano lo da el grafo
+    vector<int> tamanos;
+    if (!archivo.empty()) {
+        tamanos = {0};
+        densidades = {"archivo"};
+    } else {
+        // validar todos los tamanos antes de medir
+        for (auto &n : nodos) {
+            int V;
+            if (!leerEntero(n, V) || V < 1) {
+                cerr << "Numero de nodos invalido: " << n << "\n";
+                return 1;
+            }
+            tamanos.push_back(V);
+            for (auto &d : densidades) {
+                int64_t E = aristasPorDensidad(V, d);
+                if (E < 0) {
+                    cerr << "Densidad invalida: " << d << "\n";
+                    return 1;
+                }
+                if (E > numeric_limits<int>::max()) {
+                    cerr << "Demasiadas aristas para V=" << V << " y densidad "
+                         << d << ": " << E << "\n";
+                    return 1;
+                }
+            }
+        }
+    }
+
+    // abrir la salida antes de medir para no perder el barrido
+    ofstream out;
+    if (!salida.empty()) {
+        out.open(salida.c_str());
+        if (!out) {
+            cerr << "No se pudo escribir el archivo " << salida << "\n";
+            return 1;
+        }
+    }
+
+    vector<MedicionMST> mediciones;
+    for (int V : tamanos) {
+        for (auto &d : densidades) {
+            MedicionMST m;
+            for (int r = 0; r < calentamiento; r++) {
+                if (!medirMST(V, d, archivo, semilla + r, m)) return 1;
+            }
+            for (int r = 0; r < repeticiones; r++) {
+                if (!medirMST(V, d, archivo, semilla + r, m)) return 1;
+                m.repeticion = r;
+                mediciones.push_back(m);
+            }
+        }
+    }
+
+    bool json = (formato == "json");
+    if (salida.empty()) {
+        escribirMediciones(cout, mediciones, json);
+    } else {
+        escribirMediciones(out, mediciones, json);
+        out.close();
+        if (out.fail()) {
+            cerr << "No se pudo escribir el archivo " << salida << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// menu interactivo o modo benchmark; main guarda el reporte en ambos casos
+int ejecutar(int argc, char *argv[]) {
+    if (argc > 1 && string(argv[1]) == "--bench") return benchmark(argc, argv);
+
     int opcion;
     cout << "Opciones:\n";
     cout << "1. Leer grafo desde archivo\n";
     cout << "2. Generar grafo disperso (3V)\n";
     cout << "3. Generar grafo denso (V(V-1)/4)\n";
+    cout << "4. Validar MST dinamico contra recalculo\n";
+    cout << "5. Kruskal externo desde archivo (texto o .bin)\n";
     cout << "Opcion: ";
     cin >> opcion;
 
+    if (opcion == 4) {
+        int nodos, operaciones;
+        cout << "Numero de nodos: ";
+        cin >> nodos;
+        cout << "Numero de operaciones: ";
+        cin >> operaciones;
+        bool ok;
+        {
+            instr::Temporizador t("validar_dinamico");
+            ok = validarMSTDinamico(nodos, 3 * nodos, operaciones);
+        }
+        cout << (ok ? "El MST dinamico coincide con el recalculo\n"
+                    : "El MST dinamico no coincide\n");
+        return ok ? 0 : 1;
+    }
+
+    if (opcion == 5) {
+        string entrada, salida;
+        size_t bloque;
+        cout << "Archivo de aristas: ";
+        cin >> entrada;
+        cout << "Aristas por bloque en memoria: ";
+        cin >> bloque;
+        cout << "Archivo de salida del MST: ";
+        cin >> salida;
+        ResultadoMST r;
+        bool ok;
+        {
+            instr::Temporizador t("kruskal_externo");
+            ok = kruskalExterno(entrada, r, bloque);
+        }
+        if (!ok) return 1;
+        cout << "Costo Kruskal externo=" << r.costo << " aristas=" << r.aristas.size() << "\n";
+        return escribirAristas(salida, r.aristas) ? 0 : 1;
+    }
+
     int V;
     vector<Edge> edges;
     vector<vector<pair<int,int>>> visitado;
@@ -161,23 +1025,33 @@ int main() {
     }
 
     // Medir tiempo de kruskal 
-    clock_t t1 = clock();
-    int cK = kruskal(V, edges);
-    clock_t t2 = clock();
-    double tiempoK = double(t2 - t1)*1000.0 / CLOCKS_PER_SEC;
+    ResultadoMST rK, rP;
+    {
+        instr::Temporizador t("kruskal");
+        rK = kruskal(V, edges);
+    }
+    double tiempoK = instr::tiempoMs("kruskal");
 
     // Medir tiempo de prim
-    t1 = clock();
-    int cP = prim(V, visitado);
-    t2 = clock();
-    double tiempoP = double(t2 - t1)*1000.0 / CLOCKS_PER_SEC;
+    {
+        instr::Temporizador t("prim");
+        rP = prim(V, visitado);
+    }
+    double tiempoP = instr::tiempoMs("prim");
     
     cout << "Resultados:\n";
-    cout << "Costo Kruskal=" << cK << " tiempo=" << tiempoK << "ms\n";
-    cout << "Costo Prim=" << cP << " tiempo=" << tiempoP << "ms\n";
+    cout << "Costo Kruskal=" << rK.costo << " tiempo=" << tiempoK << "ms\n";
+    cout << "Costo Prim=" << rP.costo << " tiempo=" << tiempoP << "ms\n";
 
-    if (cK == cP) cout << "Los costos coinciden\n";
+    if (rK.costo == rP.costo) cout << "Los costos coinciden\n";
     else cout << "Los costos son diferentes\n";
 
-    return 0;
+    // guardar el arbol de kruskal en formato de texto
+    return escribirAristas("mst_kruskal.txt", rK.aristas) ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+    int codigo = ejecutar(argc, argv);
+    instr::guardarReporte("instrumentacion_mst.json", "MST");
+    return codigo;
 }
\ No newline at end of file